@@ -6,6 +6,7 @@
 #endif
 
 #include <memory>
+#include <atomic>
 #include "type.hpp"
 
 namespace alloc
@@ -35,9 +36,14 @@ namespace alloc
 		virtual ~IMemoryArray() {};
 	};
 
-	class MemoryHeap : public IMemoryArray
+	class MemoryHeap final : public IMemoryArray
 	{
 	public:
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
+		{
+			return ::operator new(n, std::nothrow);
+		}
+
 		void* allocate(size_t n) override
 		{
 			return ::operator new(n);
@@ -47,9 +53,14 @@ namespace alloc
 		{
 			::operator delete(p);
 		}
+
+		bool owns(void*) const noexcept
+		{
+			return true;
+		}
 	};
 
-	class MemoryLinear : public IMemoryArray
+	class MemoryLinear final : public IMemoryArray
 	{
 	private:
 		void* next_alloc;
@@ -66,7 +77,7 @@ namespace alloc
 		MemoryLinear(MemoryLinear&&) = delete;
 		MemoryLinear& operator=(MemoryLinear&&) = delete;
 
-		void* allocate(size_t n) override 
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
 		{
 			if (busy + n <= memory_size)
 			{
@@ -76,16 +87,31 @@ namespace alloc
 				return rs;
 			}
 			else
+				return nullptr;
+		}
+
+		void* allocate(size_t n) override 
+		{
+			void* rs = allocate(n, std::nothrow);
+			if (rs == nullptr)
 				throw bad_alloc(RESOURCE_OVERFLOW);
+			return rs;
 		}
 
 		void deallocate(void*, size_t) override
 		{
 			return;
 		}
+
+		bool owns(void* p) const noexcept
+		{
+			const byte_t* begin = reinterpret_cast<const byte_t*>(next_alloc) - busy;
+			const byte_t* loc = reinterpret_cast<const byte_t*>(p);
+			return loc >= begin && loc < begin + memory_size;
+		}
 	};
 
-	class MemoryStack : public IMemoryArray
+	class MemoryStack final : public IMemoryArray
 	{
 	private:
 		struct node
@@ -119,7 +145,7 @@ namespace alloc
 		MemoryStack(MemoryStack&&) = delete;
 		MemoryStack& operator=(MemoryStack&&) = delete;
 
-		void* allocate(size_t n) override 
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
 		{
 			if (busy + n <= memory_size)
 			{
@@ -131,7 +157,15 @@ namespace alloc
 				return rs;
 			}
 			else
+				return nullptr;
+		}
+
+		void* allocate(size_t n) override 
+		{
+			void* rs = allocate(n, std::nothrow);
+			if (rs == nullptr)
 				throw bad_alloc(RESOURCE_OVERFLOW);
+			return rs;
 		}
 
 		void deallocate(void*, size_t) override
@@ -146,6 +180,13 @@ namespace alloc
 				throw bad_dealloc(EMPTY_STACK);
 		}
 
+		bool owns(void* p) const noexcept
+		{
+			const byte_t* begin = reinterpret_cast<const byte_t*>(next_alloc) - busy;
+			const byte_t* loc = reinterpret_cast<const byte_t*>(p);
+			return loc >= begin && loc < begin + memory_size;
+		}
+
 		~MemoryStack() override
 		{
 			if (stack != nullptr)
@@ -156,7 +197,7 @@ namespace alloc
 		}
 	};
 
-	class MemoryPool : public IMemoryArray
+	class MemoryPool final : public IMemoryArray
 	{
 	private:
 		struct node
@@ -177,15 +218,17 @@ namespace alloc
 	public:
 		const size_t memory_size;
 		const size_t h;
+		const size_t pool_capacity;
 
 		MemoryPool(void* p, size_t count, size_t pool_h)
-			: memory_size(count), pool_size(1), next_alloc_index(0), busy(0), h(pool_h), memory_begin(p)
+			: memory_size(count), pool_size(1), next_alloc_index(0), busy(0), h(pool_h), memory_begin(p),
+			pool_capacity(count / pool_h + 1)
 		{
 			std::align_val_t align_val = std::align_val_t(alignof(node));
-			pool = reinterpret_cast<node*>(::operator new(meta_memory_size, align_val, std::nothrow));
+			pool = reinterpret_cast<node*>(::operator new(pool_capacity * sizeof(node), align_val, std::nothrow));
 			if (pool == nullptr)
 				throw bad_resource(MANAGER_MEMORY_OUT_OF_RANGE);
-			pool[0] = node(p, false, meta_memory_size);
+			pool[0] = node(p, false, pool_capacity);
 		}
 
 		MemoryPool(const MemoryPool&) = delete;
@@ -194,17 +237,17 @@ namespace alloc
 		MemoryPool(MemoryPool&&) = delete;
 		MemoryPool& operator=(MemoryPool&&) = delete;
 
-		void* allocate(size_t) override
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
 		{
-			if (busy + h <= memory_size)
+			if (n <= h && busy + h <= memory_size)
 			{
 				node& rs = pool[next_alloc_index];
 				rs.lock = true;
-				if (rs.next_alloc_index == meta_memory_size)
+				if (rs.next_alloc_index == pool_capacity)
 				{
 					rs.next_alloc_index = pool_size;
 					pool[pool_size] = node(reinterpret_cast<byte_t*>(memory_begin)
-						+ h * pool_size, false, meta_memory_size);
+						+ h * pool_size, false, pool_capacity);
 					next_alloc_index = pool_size;
 					++pool_size;
 				}
@@ -214,7 +257,15 @@ namespace alloc
 				return rs.loc;
 			}
 			else
+				return nullptr;
+		}
+
+		void* allocate(size_t n) override
+		{
+			void* rs = allocate(n, std::nothrow);
+			if (rs == nullptr)
 				throw bad_alloc(RESOURCE_OVERFLOW);
+			return rs;
 		}
 
 		void deallocate(void* p, size_t) override
@@ -229,6 +280,13 @@ namespace alloc
 			busy -= h;
 		}
 
+		bool owns(void* p) const noexcept
+		{
+			const byte_t* begin = reinterpret_cast<const byte_t*>(memory_begin);
+			const byte_t* loc = reinterpret_cast<const byte_t*>(p);
+			return loc >= begin && loc < begin + memory_size;
+		}
+
 		~MemoryPool() override
 		{
 			if (pool != nullptr)
@@ -239,6 +297,124 @@ namespace alloc
 		}
 	};
 
+	class MemoryRing final : public IMemoryArray
+	{
+	private:
+		struct record
+		{
+			size_t size;
+			bool free;
+
+			record(size_t size, bool free) noexcept
+				: size(size), free(free) {}
+		};
+
+		constexpr static size_t header_size = (sizeof(record) + alignof(std::max_align_t) - 1)
+			/ alignof(std::max_align_t) * alignof(std::max_align_t);
+
+		constexpr static size_t align_up(size_t n) noexcept
+		{
+			return (n + header_size - 1) / header_size * header_size;
+		}
+
+		static size_t begin_offset(void* p) noexcept
+		{
+			return align_up(reinterpret_cast<size_t>(p)) - reinterpret_cast<size_t>(p);
+		}
+
+		byte_t* memory_begin;
+	public:
+		const size_t memory_size;
+		const bool spsc;
+	private:
+		alignas(64) std::atomic<size_t> head;
+		alignas(64) std::atomic<size_t> tail;
+
+		size_t load(const std::atomic<size_t>& cursor) const noexcept
+		{
+			return spsc ? cursor.load(std::memory_order_acquire) : cursor.load(std::memory_order_relaxed);
+		}
+
+		void store(std::atomic<size_t>& cursor, size_t value) noexcept
+		{
+			if (spsc)
+				cursor.store(value, std::memory_order_release);
+			else
+				cursor.store(value, std::memory_order_relaxed);
+		}
+	public:
+		MemoryRing(void* p, size_t count, bool spsc = false) noexcept
+			: memory_begin(reinterpret_cast<byte_t*>(p) + begin_offset(p)),
+			memory_size(count > begin_offset(p) ? (count - begin_offset(p)) / header_size * header_size : 0),
+			spsc(spsc), head(0), tail(0) {}
+
+		MemoryRing(const MemoryRing&) = delete;
+		MemoryRing& operator=(const MemoryRing&) = delete;
+
+		MemoryRing(MemoryRing&&) = delete;
+		MemoryRing& operator=(MemoryRing&&) = delete;
+
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
+		{
+			size_t size = align_up(header_size + n);
+			if (size > memory_size)
+				return nullptr;
+			size_t h = head.load(std::memory_order_relaxed);
+			size_t t = load(tail);
+			size_t offset = h % memory_size;
+			size_t pad = memory_size - offset < size ? memory_size - offset : 0;
+			if (h - t + pad + size <= memory_size)
+			{
+				if (pad > 0)
+				{
+					new (memory_begin + offset) record(pad, true);
+					offset = 0;
+				}
+				new (memory_begin + offset) record(size, false);
+				store(head, h + pad + size);
+				return memory_begin + offset + header_size;
+			}
+			else
+				return nullptr;
+		}
+
+		void* allocate(size_t n) override
+		{
+			void* rs = allocate(n, std::nothrow);
+			if (rs == nullptr)
+				throw bad_alloc(RESOURCE_OVERFLOW);
+			return rs;
+		}
+
+		void deallocate(void* p, size_t) override
+		{
+			if (!owns(p))
+				throw bad_dealloc(DISPOS_PTR);
+			reinterpret_cast<record*>(reinterpret_cast<byte_t*>(p) - header_size)->free = true;
+			size_t t = tail.load(std::memory_order_relaxed);
+			size_t h = load(head);
+			while (t != h)
+			{
+				record* rs = reinterpret_cast<record*>(memory_begin + t % memory_size);
+				if (!rs->free)
+					break;
+				t += rs->size;
+			}
+			if (t == h && !spsc)
+			{
+				head.store(0, std::memory_order_relaxed);
+				t = 0;
+			}
+			store(tail, t);
+		}
+
+		bool owns(void* p) const noexcept
+		{
+			const byte_t* loc = reinterpret_cast<const byte_t*>(p);
+			return loc >= memory_begin && loc < memory_begin + memory_size;
+		}
+	};
+
 	class MemoryResource
 	{
 	private:
@@ -270,6 +446,9 @@ namespace alloc
 			case POOL:
 				resource = new MemoryPool(memory, memory_size, pool_h);
 				break;
+			case RING:
+				resource = new MemoryRing(memory, memory_size);
+				break;
 			default:
 				throw bad_resource(UNCORRECT_MANAGER_TYPE);
 				break;
@@ -290,6 +469,11 @@ namespace alloc
 			: memory_size(n), mm_type(mm_type), type_info({ t_size, align }), 
 			copy_assignment(copy_assignment), pool_h(h) {}
 
+		explicit MemoryResource(IMemoryArray* manager,
+			size_t align = alignof(std::max_align_t), size_t t_size = sizeof(std::max_align_t)) noexcept
+			: memory(nullptr), resource(manager), free_state(true), memory_size(0),
+			mm_type(CUSTOM), type_info({ t_size, align }), copy_assignment(true), pool_h(0) {}
+
 		MemoryResource(const MemoryResource&) = delete;
 		MemoryResource& operator=(const MemoryResource&) = delete;
 
@@ -329,6 +513,11 @@ namespace alloc
 				::operator delete(memory, align_val, std::nothrow);
 				delete resource;
 			}
+			else if (free_state && mm_type == CUSTOM)
+			{
+				free_state = false;
+				delete resource;
+			}
 		}
 	};
 
@@ -358,6 +547,11 @@ namespace alloc
 			: other_resources(), other_resources_count(0)
 		{
 			parent = (void*)&other;
+			if (other.resource->mm_type == CUSTOM)
+			{
+				resource = other.resource;
+				return;
+			}
 			Allocator<byte_t>* current = reinterpret_cast<Allocator<byte_t>*>(parent);
 			while (current->parent != nullptr)
 				current = reinterpret_cast<Allocator<byte_t>*>(current->parent);
@@ -0,0 +1,172 @@
+#ifndef ALLOC_CACHE
+#define ALLOC_CACHE
+
+#include <mutex>
+#include <thread>
+#include "compose.hpp"
+
+namespace alloc
+{
+	template <typename Type>
+	class ObjectCache
+	{
+	private:
+		static_assert(alignof(Type) <= alignof(std::max_align_t));
+
+		struct magazine
+		{
+			std::mutex lock;
+			std::vector<Type*> rounds;
+		};
+
+		MemoryArena<MemoryPool> slab;
+		std::vector<Type*> depot;
+		std::mutex depot_lock;
+		std::unique_ptr<magazine[]> magazines;
+		void (*reset)(Type&);
+	public:
+		const size_t magazine_size;
+		const size_t magazine_count;
+	private:
+		magazine& local_magazine() noexcept
+		{
+			thread_local const size_t id = std::hash<std::thread::id>()(std::this_thread::get_id());
+			return magazines[id % magazine_count];
+		}
+
+		void refill(magazine& mag)
+		{
+			std::lock_guard<std::mutex> guard(depot_lock);
+			while (!depot.empty() && mag.rounds.size() < magazine_size / 2 + 1)
+			{
+				mag.rounds.push_back(depot.back());
+				depot.pop_back();
+			}
+		}
+
+		void flush(magazine& mag, size_t keep)
+		{
+			std::lock_guard<std::mutex> guard(depot_lock);
+			while (mag.rounds.size() > keep)
+			{
+				depot.push_back(mag.rounds.back());
+				mag.rounds.pop_back();
+			}
+		}
+
+		Type* steal()
+		{
+			for (size_t i = 0; i < magazine_count; ++i)
+			{
+				std::lock_guard<std::mutex> guard(magazines[i].lock);
+				flush(magazines[i], 0);
+			}
+			std::lock_guard<std::mutex> guard(depot_lock);
+			if (depot.empty())
+				return nullptr;
+			Type* rs = depot.back();
+			depot.pop_back();
+			return rs;
+		}
+	public:
+		explicit ObjectCache(size_t capacity, void (*reset)(Type&) = nullptr, size_t magazine_size = 16,
+			size_t magazine_count = std::thread::hardware_concurrency())
+			: slab(capacity * sizeof(Type), sizeof(Type)), reset(reset),
+			magazine_size(magazine_size > 0 ? magazine_size : 1),
+			magazine_count(magazine_count > 0 ? magazine_count : 1)
+		{
+			depot.reserve(capacity);
+			magazines.reset(new magazine[this->magazine_count]);
+			for (size_t i = 0; i < this->magazine_count; ++i)
+				magazines[i].rounds.reserve(this->magazine_size);
+		}
+
+		ObjectCache(const ObjectCache&) = delete;
+		ObjectCache& operator=(const ObjectCache&) = delete;
+
+		ObjectCache(ObjectCache&&) = delete;
+		ObjectCache& operator=(ObjectCache&&) = delete;
+
+		Type* acquire()
+		{
+			magazine& mag = local_magazine();
+			Type* rs = nullptr;
+			{
+				std::lock_guard<std::mutex> guard(mag.lock);
+				if (mag.rounds.empty())
+					refill(mag);
+				if (!mag.rounds.empty())
+				{
+					rs = mag.rounds.back();
+					mag.rounds.pop_back();
+				}
+			}
+
+			void* p = nullptr;
+			if (rs == nullptr)
+			{
+				std::lock_guard<std::mutex> guard(depot_lock);
+				p = slab.allocate(sizeof(Type), std::nothrow);
+			}
+			if (rs == nullptr && p == nullptr)
+			{
+				rs = steal();
+				if (rs == nullptr)
+					throw bad_alloc(RESOURCE_OVERFLOW);
+			}
+			if (rs != nullptr)
+			{
+				if (reset != nullptr)
+					reset(*rs);
+				return rs;
+			}
+
+			try
+			{
+				return new (p) Type();
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> guard(depot_lock);
+				slab.deallocate(p, sizeof(Type));
+				throw;
+			}
+		}
+
+		void release(Type* p)
+		{
+			magazine& mag = local_magazine();
+			std::lock_guard<std::mutex> guard(mag.lock);
+			if (mag.rounds.size() == magazine_size)
+				flush(mag, magazine_size / 2);
+			mag.rounds.push_back(p);
+		}
+
+		size_t trim(size_t keep = 0)
+		{
+			for (size_t i = 0; i < magazine_count; ++i)
+			{
+				std::lock_guard<std::mutex> guard(magazines[i].lock);
+				flush(magazines[i], 0);
+			}
+			std::lock_guard<std::mutex> guard(depot_lock);
+			size_t count = 0;
+			while (depot.size() > keep)
+			{
+				Type* p = depot.back();
+				depot.pop_back();
+				p->~Type();
+				slab.deallocate(p, sizeof(Type));
+				++count;
+			}
+			return count;
+		}
+
+		~ObjectCache()
+		{
+			trim();
+		}
+	};
+}
+
+#endif
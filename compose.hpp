@@ -0,0 +1,320 @@
+#ifndef ALLOC_COMPOSE
+#define ALLOC_COMPOSE
+
+#include <cstddef>
+#include <tuple>
+#include "alloc.hpp"
+
+namespace alloc
+{
+	struct no_affix {};
+
+	template <typename Manager>
+	class MemoryArena final : public IMemoryArray
+	{
+	private:
+		struct buffer
+		{
+			byte_t* loc;
+
+			explicit buffer(size_t count)
+			{
+				std::align_val_t align_val = std::align_val_t(alignof(std::max_align_t));
+				loc = reinterpret_cast<byte_t*>(::operator new(count, align_val, std::nothrow));
+				if (loc == nullptr)
+					throw bad_resource(RESOURCE_NOT_INSTANCE);
+			}
+
+			buffer(const buffer&) = delete;
+			buffer& operator=(const buffer&) = delete;
+
+			~buffer()
+			{
+				std::align_val_t align_val = std::align_val_t(alignof(std::max_align_t));
+				::operator delete(loc, align_val, std::nothrow);
+			}
+		};
+
+		buffer memory;
+		Manager manager;
+	public:
+		template <typename ...Args>
+		explicit MemoryArena(size_t count, Args&&... args)
+			: memory(count), manager(memory.loc, count, std::forward<Args>(args)...) {}
+
+		MemoryArena(const MemoryArena&) = delete;
+		MemoryArena& operator=(const MemoryArena&) = delete;
+
+		MemoryArena(MemoryArena&&) = delete;
+		MemoryArena& operator=(MemoryArena&&) = delete;
+
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
+		{
+			return manager.allocate(n, std::nothrow);
+		}
+
+		void* allocate(size_t n) override
+		{
+			return manager.allocate(n);
+		}
+
+		void deallocate(void* p, size_t n) override
+		{
+			manager.deallocate(p, n);
+		}
+
+		bool owns(void* p) const noexcept
+		{
+			return manager.owns(p);
+		}
+	};
+
+	template <typename Primary, typename Secondary>
+	class Fallback final : public IMemoryArray
+	{
+	private:
+		Primary primary;
+		Secondary secondary;
+	public:
+		Fallback() = default;
+
+		template <typename ...PrimaryArgs, typename ...SecondaryArgs>
+		Fallback(std::tuple<PrimaryArgs...> primary_args, std::tuple<SecondaryArgs...> secondary_args)
+			: primary(std::make_from_tuple<Primary>(std::move(primary_args))),
+			secondary(std::make_from_tuple<Secondary>(std::move(secondary_args))) {}
+
+		Fallback(const Fallback&) = delete;
+		Fallback& operator=(const Fallback&) = delete;
+
+		Fallback(Fallback&&) = delete;
+		Fallback& operator=(Fallback&&) = delete;
+
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
+		{
+			void* rs = primary.allocate(n, std::nothrow);
+			if (rs == nullptr)
+				rs = secondary.allocate(n, std::nothrow);
+			return rs;
+		}
+
+		void* allocate(size_t n) override
+		{
+			void* rs = primary.allocate(n, std::nothrow);
+			if (rs == nullptr)
+				rs = secondary.allocate(n);
+			return rs;
+		}
+
+		void deallocate(void* p, size_t n) override
+		{
+			if (primary.owns(p))
+				primary.deallocate(p, n);
+			else
+				secondary.deallocate(p, n);
+		}
+
+		bool owns(void* p) const noexcept
+		{
+			return primary.owns(p) || secondary.owns(p);
+		}
+	};
+
+	template <size_t Threshold, typename Small, typename Large>
+	class Segregator final : public IMemoryArray
+	{
+	private:
+		Small small;
+		Large large;
+	public:
+		Segregator() = default;
+
+		template <typename ...SmallArgs, typename ...LargeArgs>
+		Segregator(std::tuple<SmallArgs...> small_args, std::tuple<LargeArgs...> large_args)
+			: small(std::make_from_tuple<Small>(std::move(small_args))),
+			large(std::make_from_tuple<Large>(std::move(large_args))) {}
+
+		Segregator(const Segregator&) = delete;
+		Segregator& operator=(const Segregator&) = delete;
+
+		Segregator(Segregator&&) = delete;
+		Segregator& operator=(Segregator&&) = delete;
+
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
+		{
+			if (n <= Threshold)
+				return small.allocate(n, std::nothrow);
+			else
+				return large.allocate(n, std::nothrow);
+		}
+
+		void* allocate(size_t n) override
+		{
+			if (n <= Threshold)
+				return small.allocate(n);
+			else
+				return large.allocate(n);
+		}
+
+		void deallocate(void* p, size_t n) override
+		{
+			if (n <= Threshold)
+				small.deallocate(p, n);
+			else
+				large.deallocate(p, n);
+		}
+
+		bool owns(void* p) const noexcept
+		{
+			return small.owns(p) || large.owns(p);
+		}
+	};
+
+	template <typename Manager, typename Prefix, typename Suffix = no_affix>
+	class Affix final : public IMemoryArray
+	{
+	private:
+		static_assert(std::is_nothrow_default_constructible_v<Prefix>
+			&& std::is_nothrow_default_constructible_v<Suffix>);
+
+		constexpr static bool has_prefix = !std::is_same_v<Prefix, no_affix>;
+		constexpr static bool has_suffix = !std::is_same_v<Suffix, no_affix>;
+
+		constexpr static size_t align_up(size_t n, size_t align) noexcept
+		{
+			return (n + align - 1) / align * align;
+		}
+
+		constexpr static size_t prefix_size = has_prefix ? align_up(sizeof(Prefix), alignof(std::max_align_t)) : 0;
+
+		constexpr static size_t suffix_offset(size_t n) noexcept
+		{
+			return has_suffix ? align_up(n, alignof(Suffix)) : n;
+		}
+
+		constexpr static size_t block_size(size_t n) noexcept
+		{
+			return prefix_size + suffix_offset(n) + (has_suffix ? sizeof(Suffix) : 0);
+		}
+
+		static void* emplace(void* block, size_t n) noexcept
+		{
+			byte_t* rs = reinterpret_cast<byte_t*>(block) + prefix_size;
+			if constexpr (has_prefix)
+				new (block) Prefix();
+			if constexpr (has_suffix)
+				new (rs + suffix_offset(n)) Suffix();
+			return rs;
+		}
+
+		Manager manager;
+	public:
+		template <typename ...Args>
+		explicit Affix(Args&&... args)
+			: manager(std::forward<Args>(args)...) {}
+
+		Affix(const Affix&) = delete;
+		Affix& operator=(const Affix&) = delete;
+
+		Affix(Affix&&) = delete;
+		Affix& operator=(Affix&&) = delete;
+
+		static Prefix& prefix(void* p) noexcept
+		{
+			return *std::launder(reinterpret_cast<Prefix*>(reinterpret_cast<byte_t*>(p) - prefix_size));
+		}
+
+		static Suffix& suffix(void* p, size_t n) noexcept
+		{
+			return *std::launder(reinterpret_cast<Suffix*>(reinterpret_cast<byte_t*>(p) + suffix_offset(n)));
+		}
+
+		void* allocate(size_t n, const std::nothrow_t&) noexcept
+		{
+			void* block = manager.allocate(block_size(n), std::nothrow);
+			if (block == nullptr)
+				return nullptr;
+			return emplace(block, n);
+		}
+
+		void* allocate(size_t n) override
+		{
+			return emplace(manager.allocate(block_size(n)), n);
+		}
+
+		void deallocate(void* p, size_t n) override
+		{
+			if constexpr (has_suffix)
+				suffix(p, n).~Suffix();
+			if constexpr (has_prefix)
+				prefix(p).~Prefix();
+			manager.deallocate(reinterpret_cast<byte_t*>(p) - prefix_size, block_size(n));
+		}
+
+		bool owns(void* p) const noexcept
+		{
+			return manager.owns(reinterpret_cast<byte_t*>(p) - prefix_size);
+		}
+	};
+
+	template <typename Manager, typename ...Args>
+	std::shared_ptr<MemoryResource> make_composite(Args&&... args)
+	{
+		std::unique_ptr<Manager> manager(new Manager(std::forward<Args>(args)...));
+		std::shared_ptr<MemoryResource> rs = std::make_shared<MemoryResource>(manager.get());
+		manager.release();
+		return rs;
+	}
+
+	template <typename Type, typename Manager>
+	class CompositeAllocator
+	{
+	private:
+		std::shared_ptr<Manager> manager;
+
+		template <typename Rebind, typename Other>
+		friend class CompositeAllocator;
+	public:
+		using value_type = Type;
+
+		explicit CompositeAllocator(std::shared_ptr<Manager> location) noexcept
+			: manager(location) {}
+
+		template <typename Rebind>
+		CompositeAllocator(const CompositeAllocator<Rebind, Manager>& other) noexcept
+			: manager(other.manager) {}
+
+		Type* allocate(size_t n)
+		{
+			return reinterpret_cast<Type*>(manager->allocate(n * sizeof(Type)));
+		}
+
+		void deallocate(Type* p, size_t n)
+		{
+			manager->deallocate(p, n * sizeof(Type));
+		}
+
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		template <typename OtherType>
+		bool equal(const CompositeAllocator<OtherType, Manager>& other) const noexcept
+		{
+			return manager.get() == other.manager.get();
+		}
+	};
+
+	template <typename Type_A, typename Type_B, typename Manager>
+	bool operator==(const CompositeAllocator<Type_A, Manager>& a, const CompositeAllocator<Type_B, Manager>& b)
+	{
+		return a.equal(b);
+	}
+
+	template <typename Type_A, typename Type_B, typename Manager>
+	bool operator!=(const CompositeAllocator<Type_A, Manager>& a, const CompositeAllocator<Type_B, Manager>& b)
+	{
+		return !a.equal(b);
+	}
+}
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef ALLOC_EPOCH
+#define ALLOC_EPOCH
+
+#include <mutex>
+#include <atomic>
+#include "alloc.hpp"
+
+namespace alloc
+{
+	class EpochResource
+	{
+	public:
+		class participant
+		{
+		private:
+			struct bucket
+			{
+				size_t epoch = 0;
+				std::vector<std::pair<void*, size_t>> blocks;
+			};
+
+			alignas(64) std::atomic<size_t> state{ 0 };
+			std::atomic<bool> used{ false };
+			alignas(64) bucket limbo[3];
+			size_t retired = 0;
+
+			friend class EpochResource;
+		};
+	private:
+		struct orphan
+		{
+			size_t epoch;
+			void* loc;
+			size_t n;
+
+			orphan(size_t epoch, void* loc, size_t n) noexcept
+				: epoch(epoch), loc(loc), n(n) {}
+		};
+
+		std::shared_ptr<MemoryResource> resource;
+		std::unique_ptr<participant[]> participants;
+		std::vector<orphan> orphans;
+		std::mutex lock;
+		std::atomic<size_t> global_epoch;
+		std::atomic<size_t> pending;
+	public:
+		const size_t max_pending;
+		const size_t max_threads;
+		const size_t batch_size;
+	private:
+		bool try_advance() noexcept
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			size_t epoch = global_epoch.load(std::memory_order_relaxed);
+			for (size_t i = 0; i < max_threads; ++i)
+			{
+				size_t state = participants[i].state.load(std::memory_order_acquire);
+				if ((state & 1) != 0 && (state >> 1) != epoch)
+					return false;
+			}
+			global_epoch.compare_exchange_strong(epoch, epoch + 1);
+			return true;
+		}
+
+		void release(participant::bucket& b)
+		{
+			size_t freed = 0;
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				for (std::pair<void*, size_t>& block : b.blocks)
+				{
+					resource->deallocate(block.first, block.second);
+					freed += block.second;
+				}
+			}
+			b.blocks.clear();
+			pending.fetch_sub(freed, std::memory_order_relaxed);
+		}
+
+		static size_t pending_limit(const std::shared_ptr<MemoryResource>& location, size_t max_pending)
+		{
+			bool bounded = location->mm_type != HEAP && location->mm_type != CUSTOM;
+			if (max_pending == 0)
+			{
+				if (!bounded)
+					throw bad_resource(UNCORRECT_PENDING_LIMIT);
+				return location->memory_size / 2;
+			}
+			if (bounded && max_pending >= location->memory_size)
+				throw bad_resource(UNCORRECT_PENDING_LIMIT);
+			return max_pending;
+		}
+
+		void collect(participant& r)
+		{
+			try_advance();
+			size_t epoch = global_epoch.load(std::memory_order_acquire);
+			for (participant::bucket& b : r.limbo)
+				if (!b.blocks.empty() && b.epoch + 2 <= epoch)
+					release(b);
+
+			size_t freed = 0;
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				for (size_t i = 0; i < orphans.size();)
+				{
+					if (orphans[i].epoch + 2 <= epoch)
+					{
+						resource->deallocate(orphans[i].loc, orphans[i].n);
+						freed += orphans[i].n;
+						orphans[i] = orphans.back();
+						orphans.pop_back();
+					}
+					else
+						++i;
+				}
+			}
+			pending.fetch_sub(freed, std::memory_order_relaxed);
+		}
+	public:
+		explicit EpochResource(std::shared_ptr<MemoryResource> location, size_t max_pending = 0,
+			size_t max_threads = 64, size_t batch_size = 64)
+			: resource(location), participants(new participant[max_threads]), global_epoch(0), pending(0),
+			max_pending(pending_limit(location, max_pending)), max_threads(max_threads), batch_size(batch_size > 0 ? batch_size : 1) {}
+
+		EpochResource(const EpochResource&) = delete;
+		EpochResource& operator=(const EpochResource&) = delete;
+
+		EpochResource(EpochResource&&) = delete;
+		EpochResource& operator=(EpochResource&&) = delete;
+
+		participant& attach()
+		{
+			for (size_t i = 0; i < max_threads; ++i)
+			{
+				bool expected = false;
+				if (participants[i].used.compare_exchange_strong(expected, true))
+					return participants[i];
+			}
+			throw bad_resource(PARTICIPANTS_OVERFLOW);
+		}
+
+		void detach(participant& r)
+		{
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				for (participant::bucket& b : r.limbo)
+				{
+					for (std::pair<void*, size_t>& block : b.blocks)
+						orphans.emplace_back(b.epoch, block.first, block.second);
+					b.blocks.clear();
+				}
+			}
+			r.retired = 0;
+			r.used.store(false, std::memory_order_release);
+		}
+
+		void enter(participant& r) noexcept
+		{
+			size_t epoch = global_epoch.load(std::memory_order_relaxed);
+			r.state.store(epoch << 1 | 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+
+		void exit(participant& r) noexcept
+		{
+			r.state.store(0, std::memory_order_release);
+		}
+
+		void* allocate(participant& r, size_t n)
+		{
+			if (pending.load(std::memory_order_relaxed) > max_pending)
+			{
+				collect(r);
+				if (pending.load(std::memory_order_relaxed) > max_pending)
+					throw bad_alloc(RESOURCE_OVERFLOW);
+			}
+			std::lock_guard<std::mutex> guard(lock);
+			return resource->allocate(n);
+		}
+
+		void retire(participant& r, void* p, size_t n)
+		{
+			size_t epoch = global_epoch.load(std::memory_order_seq_cst);
+			participant::bucket& b = r.limbo[epoch % 3];
+			if (b.epoch != epoch)
+			{
+				if (!b.blocks.empty())
+					release(b);
+				b.epoch = epoch;
+			}
+			b.blocks.emplace_back(p, n);
+			pending.fetch_add(n, std::memory_order_relaxed);
+			if (++r.retired % batch_size == 0)
+				collect(r);
+		}
+
+		size_t pending_size() const noexcept
+		{
+			return pending.load(std::memory_order_relaxed);
+		}
+
+		~EpochResource()
+		{
+			for (size_t i = 0; i < max_threads; ++i)
+				for (participant::bucket& b : participants[i].limbo)
+					for (std::pair<void*, size_t>& block : b.blocks)
+						resource->deallocate(block.first, block.second);
+			for (orphan& block : orphans)
+				resource->deallocate(block.loc, block.n);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef ALLOC_HANDLE
+#define ALLOC_HANDLE
+
+#include <cstdint>
+#include <algorithm>
+#include "alloc.hpp"
+
+namespace alloc
+{
+	struct handle_t
+	{
+		constexpr static uint32_t index_bits = 20;
+		constexpr static uint32_t index_mask = (1u << index_bits) - 1;
+		constexpr static uint32_t generation_mask = (1u << (32 - index_bits)) - 1;
+
+		uint32_t value;
+
+		uint32_t index() const noexcept
+		{
+			return value & index_mask;
+		}
+
+		uint32_t generation() const noexcept
+		{
+			return value >> index_bits;
+		}
+
+		bool operator==(const handle_t& other) const noexcept
+		{
+			return value == other.value;
+		}
+
+		bool operator!=(const handle_t& other) const noexcept
+		{
+			return value != other.value;
+		}
+	};
+
+	constexpr handle_t null_handle = { 0 };
+
+	template <typename Type>
+	class HandlePool
+	{
+	private:
+		static_assert(std::is_nothrow_move_constructible_v<Type>);
+
+		constexpr static uint32_t npos = UINT32_MAX;
+
+		struct slot
+		{
+			uint32_t position;
+			uint32_t generation;
+
+			slot(uint32_t position, uint32_t generation) noexcept
+				: position(position), generation(generation) {}
+		};
+
+		std::vector<byte_t*> pages;
+		std::vector<slot> slots;
+		std::vector<uint32_t> owners;
+		std::vector<uint32_t> free_slots;
+		std::vector<uint32_t> holes;
+		size_t live;
+	public:
+		const size_t page_count;
+	private:
+		Type* at(uint32_t position) const noexcept
+		{
+			return reinterpret_cast<Type*>(pages[position / page_count]) + position % page_count;
+		}
+
+		byte_t* page_alloc()
+		{
+			std::align_val_t align_val = std::align_val_t(alignof(Type));
+			byte_t* rs = reinterpret_cast<byte_t*>(::operator new(page_count * sizeof(Type), align_val, std::nothrow));
+			if (rs == nullptr)
+				throw bad_alloc(RESOURCE_OVERFLOW);
+			return rs;
+		}
+
+		void page_free(byte_t* page) noexcept
+		{
+			std::align_val_t align_val = std::align_val_t(alignof(Type));
+			::operator delete(page, align_val, std::nothrow);
+		}
+
+		slot* lookup(handle_t h) noexcept
+		{
+			uint32_t index = h.index();
+			if (index >= slots.size())
+				return nullptr;
+			slot& rs = slots[index];
+			if (rs.position == npos || rs.generation != h.generation())
+				return nullptr;
+			return &rs;
+		}
+
+		uint32_t find_hole() noexcept
+		{
+			while (!holes.empty())
+			{
+				uint32_t position = holes.back();
+				holes.pop_back();
+				if (position < owners.size() && owners[position] == npos)
+					return position;
+			}
+			return npos;
+		}
+
+		void shrink() noexcept
+		{
+			while (!owners.empty() && owners.back() == npos)
+				owners.pop_back();
+		}
+
+		template <typename Elem>
+		static void reserve_next(std::vector<Elem>& v)
+		{
+			if (v.size() == v.capacity())
+				v.reserve(v.capacity() > 0 ? 2 * v.capacity() : 1);
+		}
+	public:
+		explicit HandlePool(size_t page_size = MemoryUnit<4, KiB>::byte())
+			: live(0), page_count(page_size / sizeof(Type) > 0 ? page_size / sizeof(Type) : 1) {}
+
+		HandlePool(const HandlePool&) = delete;
+		HandlePool& operator=(const HandlePool&) = delete;
+
+		HandlePool(HandlePool&&) = delete;
+		HandlePool& operator=(HandlePool&&) = delete;
+
+		template <typename ...Args>
+		handle_t create(Args&&... args)
+		{
+			if (free_slots.empty() && slots.size() > handle_t::index_mask)
+				throw bad_alloc(RESOURCE_OVERFLOW);
+			reserve_next(slots);
+			if (free_slots.capacity() < slots.capacity())
+				free_slots.reserve(slots.capacity());
+			reserve_next(owners);
+
+			uint32_t position = find_hole();
+			bool append = position == npos;
+			if (append)
+			{
+				position = static_cast<uint32_t>(owners.size());
+				if (position / page_count == pages.size())
+				{
+					reserve_next(pages);
+					pages.push_back(page_alloc());
+				}
+			}
+			try
+			{
+				new (at(position)) Type(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				if (!append)
+					holes.push_back(position);
+				throw;
+			}
+
+			uint32_t index;
+			if (!free_slots.empty())
+			{
+				index = free_slots.back();
+				free_slots.pop_back();
+			}
+			else
+			{
+				index = static_cast<uint32_t>(slots.size());
+				slots.push_back(slot(npos, 1));
+			}
+			slots[index].position = position;
+			if (append)
+				owners.push_back(index);
+			else
+				owners[position] = index;
+			++live;
+			return { index | slots[index].generation << handle_t::index_bits };
+		}
+
+		void destroy(handle_t h)
+		{
+			slot* s = lookup(h);
+			if (s == nullptr)
+				throw bad_dealloc(STALE_HANDLE);
+			reserve_next(holes);
+			uint32_t position = s->position;
+			at(position)->~Type();
+			owners[position] = npos;
+			s->position = npos;
+			s->generation = (s->generation + 1) & handle_t::generation_mask;
+			if (s->generation == 0)
+				s->generation = 1;
+			free_slots.push_back(h.index());
+			--live;
+			if (position + 1 == owners.size())
+				shrink();
+			else
+				holes.push_back(position);
+		}
+
+		Type* get(handle_t h) noexcept
+		{
+			slot* s = lookup(h);
+			return s != nullptr ? at(s->position) : nullptr;
+		}
+
+		size_t compact(size_t budget)
+		{
+			size_t moved = 0;
+			shrink();
+			while (moved < budget)
+			{
+				uint32_t hole = find_hole();
+				if (hole == npos)
+					break;
+				uint32_t last = static_cast<uint32_t>(owners.size() - 1);
+				Type* src = at(last);
+				new (at(hole)) Type(std::move(*src));
+				src->~Type();
+				uint32_t index = owners[last];
+				slots[index].position = hole;
+				owners[hole] = index;
+				owners[last] = npos;
+				shrink();
+				++moved;
+			}
+			if (holes.size() > owners.size() - live)
+				holes.erase(std::remove_if(holes.begin(), holes.end(), [this](uint32_t position)
+					{ return position >= owners.size() || owners[position] != npos; }), holes.end());
+			size_t need = (owners.size() + page_count - 1) / page_count;
+			while (pages.size() > need)
+			{
+				page_free(pages.back());
+				pages.pop_back();
+			}
+			return moved;
+		}
+
+		template <typename Func>
+		void for_each(Func f)
+		{
+			for (uint32_t position = 0; position < owners.size(); ++position)
+				if (owners[position] != npos)
+					f(*at(position));
+		}
+
+		size_t size() const noexcept
+		{
+			return live;
+		}
+
+		bool dense() const noexcept
+		{
+			return owners.size() == live;
+		}
+
+		~HandlePool()
+		{
+			for (uint32_t position = 0; position < owners.size(); ++position)
+				if (owners[position] != npos)
+					at(position)->~Type();
+			for (byte_t* page : pages)
+				page_free(page);
+		}
+	};
+}
+
+#endif
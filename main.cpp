@@ -1,7 +1,10 @@
 #include <thread>
 
 #define DEFAULT_MEMORY_SIZE 128, MiB
-#include "alloc.hpp"
+#include "compose.hpp"
+#include "cache.hpp"
+#include "handle.hpp"
+#include "epoch.hpp"
 
 int main()
 {
@@ -60,6 +63,177 @@ int main()
     time = end - begin;
     std::cout << "pool allocator:\t\t" << time.count() << std::endl;
 
+    auto ring = alloc::make_resource(alloc::RING);
+    alloc::Allocator<int> ring_allocator(ring);
+    alloc::list<int> l5(ring_allocator);
+    begin = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        l5.push_back(i);
+        l5.pop_back();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    time = end - begin;
+    std::cout << "ring allocator:\t\t" << time.count() << std::endl;
+
+    alloc::MemoryArena<alloc::MemoryRing> spsc_ring(alloc::default_memory_size, true);
+    std::atomic<size_t*> messages[64] = {};
+    begin = std::chrono::high_resolution_clock::now();
+    std::thread producer([&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            void* loc;
+            while ((loc = spsc_ring.allocate(sizeof(size_t), std::nothrow)) == nullptr)
+                std::this_thread::yield();
+            size_t* message = new (loc) size_t(i);
+            while (messages[i % 64].load(std::memory_order_acquire) != nullptr)
+                std::this_thread::yield();
+            messages[i % 64].store(message, std::memory_order_release);
+        }
+    });
+    std::thread consumer([&]()
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            size_t* message;
+            while ((message = messages[i % 64].load(std::memory_order_acquire)) == nullptr)
+                std::this_thread::yield();
+            messages[i % 64].store(nullptr, std::memory_order_release);
+            spsc_ring.deallocate(message, sizeof(size_t));
+        }
+    });
+    producer.join();
+    consumer.join();
+    end = std::chrono::high_resolution_clock::now();
+    time = end - begin;
+    std::cout << "ring spsc (2 threads):\t" << time.count() << std::endl;
+
+    using segregator = alloc::Segregator<32, alloc::MemoryArena<alloc::MemoryPool>, alloc::MemoryHeap>;
+    auto composite = alloc::make_composite<segregator>(std::forward_as_tuple(alloc::default_memory_size, 32), std::tuple<>());
+    alloc::Allocator<int> composite_allocator(composite);
+    alloc::list<int> l6(composite_allocator);
+    begin = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        l6.push_back(i);
+        l6.pop_back();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    time = end - begin;
+    std::cout << "segregator allocator:\t" << time.count() << std::endl;
+
+    auto direct = std::make_shared<segregator>(std::forward_as_tuple(alloc::default_memory_size, 32), std::tuple<>());
+    alloc::CompositeAllocator<int, segregator> direct_allocator(direct);
+    std::list<int, alloc::CompositeAllocator<int, segregator>> l7(direct_allocator);
+    begin = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        l7.push_back(i);
+        l7.pop_back();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    time = end - begin;
+    std::cout << "segregator (direct):\t" << time.count() << std::endl;
+
+    struct context
+    {
+        std::vector<int> buffer = std::vector<int>(256);
+        size_t used = 0;
+    };
+    begin = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        context* c = new context();
+        c->used = i;
+        delete c;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    time = end - begin;
+    std::cout << "context new/delete:\t" << time.count() << std::endl;
+
+    alloc::ObjectCache<context> cache(1024, [](context& c) { c.used = 0; });
+    begin = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        context* c = cache.acquire();
+        c->used = i;
+        cache.release(c);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    time = end - begin;
+    std::cout << "object cache:\t\t" << time.count() << std::endl;
+
+    alloc::HandlePool<context> handles;
+    std::vector<alloc::handle_t> live(1024);
+    for (alloc::handle_t& h : live)
+        h = handles.create();
+    size_t used = 0;
+    begin = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        alloc::handle_t& h = live[i * 7919 % live.size()];
+        handles.destroy(h);
+        h = handles.create();
+        handles.get(h)->used = i;
+        if (i % live.size() == 0)
+        {
+            handles.compact(64);
+            handles.for_each([&](context& c) { used += c.used; });
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    time = end - begin;
+    std::cout << "handle pool:\t\t" << time.count() << std::endl;
+
+    struct node
+    {
+        size_t value;
+        node* next;
+    };
+    constexpr size_t threads_count = 4;
+    auto epoch_pool = alloc::make_resource(alloc::POOL, alignof(node), sizeof(node),
+        false, alloc::default_memory_size, sizeof(node));
+    alloc::EpochResource epoch(epoch_pool);
+    std::atomic<node*> top = nullptr;
+    std::vector<std::thread> threads;
+    begin = std::chrono::high_resolution_clock::now();
+    for (size_t t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            auto& participant = epoch.attach();
+            for (size_t i = 0; i < n / threads_count; ++i)
+            {
+                epoch.enter(participant);
+                void* loc;
+                try
+                {
+                    loc = epoch.allocate(participant, sizeof(node));
+                }
+                catch (const alloc::bad_alloc&)
+                {
+                    epoch.exit(participant);
+                    std::this_thread::yield();
+                    continue;
+                }
+                node* pushed = new (loc) node{ i, top.load() };
+                while (!top.compare_exchange_weak(pushed->next, pushed));
+                node* popped = top.load();
+                while (popped != nullptr && !top.compare_exchange_weak(popped, popped->next));
+                if (popped != nullptr)
+                    epoch.retire(participant, popped, sizeof(node));
+                epoch.exit(participant);
+            }
+            epoch.detach(participant);
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    end = std::chrono::high_resolution_clock::now();
+    time = end - begin;
+    std::cout << "epoch pool (" << threads_count << " threads):\t" << time.count() << std::endl;
+
     system("pause");
     return 0;
 }
\ No newline at end of file
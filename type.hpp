@@ -37,7 +37,10 @@ namespace alloc
 		EMPTY_STACK					= 2,
 		DISPOS_PTR					= 3,
 		RESOURCE_NOT_INSTANCE		= 4,
-		UNCORRECT_MANAGER_TYPE		= 5
+		UNCORRECT_MANAGER_TYPE		= 5,
+		STALE_HANDLE				= 6,
+		UNCORRECT_PENDING_LIMIT		= 7,
+		PARTICIPANTS_OVERFLOW		= 8
 	};
 
 	struct bad_except
@@ -68,6 +71,15 @@ namespace alloc
 			case UNCORRECT_MANAGER_TYPE:
 				return "RESOURCE NOT KNOW OF MANAGER TYPE ARGUMENT";
 				break;
+			case STALE_HANDLE:
+				return "HANDLE IS STALE OR NOT FROM THIS POOL";
+				break;
+			case UNCORRECT_PENDING_LIMIT:
+				return "PENDING LIMIT NOT SET OR NOT BELOW RESOURCE CAPACITY";
+				break;
+			case PARTICIPANTS_OVERFLOW:
+				return "NO FREE PARTICIPANT SLOT IN EPOCH RESOURCE";
+				break;
 			default:
 				return "UNDEFINED EXCEPTION";
 				break;
@@ -96,6 +108,15 @@ namespace alloc
 			case UNCORRECT_MANAGER_TYPE:
 				return L"RESOURCE NOT KNOW OF MANAGER TYPE ARGUMENT";
 				break;
+			case STALE_HANDLE:
+				return L"HANDLE IS STALE OR NOT FROM THIS POOL";
+				break;
+			case UNCORRECT_PENDING_LIMIT:
+				return L"PENDING LIMIT NOT SET OR NOT BELOW RESOURCE CAPACITY";
+				break;
+			case PARTICIPANTS_OVERFLOW:
+				return L"NO FREE PARTICIPANT SLOT IN EPOCH RESOURCE";
+				break;
 			default:
 				return L"UNDEFINED EXCEPTION";
 				break;
@@ -203,7 +224,9 @@ namespace alloc
 		HEAP   = 0,
 		LINEAR = 1,
 		STACK  = 2,
-		POOL   = 3
+		POOL   = 3,
+		RING   = 4,
+		CUSTOM = 5
 	};
 }
 